@@ -0,0 +1,39 @@
+#pragma once
+
+#include <map>
+#include <utility>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+// Process-wide cache of the images compiled in through juce_add_binary_data.
+// Every asset is decoded once, and every (asset, display scale) pair is
+// resampled once, so opening an editor does no file I/O or image decoding.
+// It is a process singleton deleted at shutdown, so the images outlive any
+// single editor or plugin instance. Only use it from the message thread.
+class AssetCache : private juce::DeletedAtShutdown
+{
+public:
+    AssetCache() = default;
+    ~AssetCache() override;
+
+    JUCE_DECLARE_SINGLETON_SINGLETHREADED(AssetCache, false)
+
+    // Returns the named BinaryData image (e.g. "oscillatorLogo_png") resampled
+    // for the given physical-pixel scale. Returns an invalid image if the
+    // resource does not exist.
+    const juce::Image &getImage(const juce::String &resourceName, float displayScale);
+
+    // Size of the asset in logical pixels, i.e. its size at a display scale of 1.
+    juce::Rectangle<int> getLogicalBounds(const juce::String &resourceName);
+
+private:
+    const juce::Image &getDecodedImage(const juce::String &resourceName);
+
+    // Display scales are stored in percent so that 1.25f and 1.2500001f share an entry
+    static int toScaleKey(float displayScale);
+
+    std::map<juce::String, juce::Image> decodedImages;
+    std::map<std::pair<juce::String, int>, juce::Image> scaledImages;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AssetCache)
+};
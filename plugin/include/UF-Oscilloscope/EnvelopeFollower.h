@@ -0,0 +1,68 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// Levels of one bus as seen by the display, published once per block
+struct TraceEnvelope
+{
+    float peak = 0.0f;
+    float rms = 0.0f;
+    bool gated = true; // True while the bus is below the silence gate
+};
+
+// Peak and RMS follower with attack/release smoothing, run incrementally on
+// the audio thread. Blocks whose peak stays below the gate threshold don't
+// move the envelope, so silence doesn't blow up an auto-scaled trace.
+class EnvelopeFollower
+{
+public:
+    EnvelopeFollower() = default;
+
+    // Must be called before process
+    void prepare(double sampleRate);
+    void reset();
+
+    void process(const juce::AudioBuffer<float> &buffer, int numChannels, int numSamples);
+
+    TraceEnvelope getEnvelope() const;
+
+private:
+    static float getCoefficient(double sampleRate, float timeMs);
+
+    static constexpr float attackMs = 5.0f;
+    static constexpr float releaseMs = 500.0f;
+    static constexpr float rmsWindowMs = 300.0f;
+    static constexpr float gateThresholdDb = -60.0f;
+
+    float gateThreshold = 0.0f;
+
+    float attackCoefficient = 0.0f;
+    float releaseCoefficient = 0.0f;
+    float rmsCoefficient = 0.0f;
+
+    float peak = 0.0f;
+    float meanSquare = 0.0f;
+    bool gated = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EnvelopeFollower)
+};
+
+// Hands a TraceEnvelope from the audio thread to the message thread as one
+// consistent set. The writer never waits; the reader retries if it overlapped
+// a write, guarded by a sequence counter that is odd while a write is in progress.
+class TraceEnvelopeSnapshot
+{
+public:
+    TraceEnvelopeSnapshot() = default;
+
+    void publish(const TraceEnvelope &envelope);
+    TraceEnvelope read() const;
+
+private:
+    std::atomic<juce::uint32> sequence{0};
+    std::atomic<float> peak{0.0f};
+    std::atomic<float> rms{0.0f};
+    std::atomic<bool> gated{true};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TraceEnvelopeSnapshot)
+};
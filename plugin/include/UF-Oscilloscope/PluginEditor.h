@@ -3,6 +3,8 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "UF-Oscilloscope/PluginProcessor.h"
 #include "UF-Oscilloscope/CustomLookAndFeel.h"
+#include "UF-Oscilloscope/AssetCache.h"
+#include "UF-Oscilloscope/TraceLayout.h"
 
 class PluginEditor final : public juce::AudioProcessorEditor,
                            private juce::Slider::Listener,
@@ -19,15 +21,23 @@ public:
     void setXScale(int newXScale);
     void setYScale(float newYScale);
 
+    void setLayoutMode(TraceLayout::Mode mode);
+    void setTraceScaling(TraceScaling scaling);
+    void setLogAmplitude(bool shouldUseLogAmplitude);
+
 private:
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     PluginProcessor &audioProcessor;
 
     float xScale = 1.0f;
-    float yScale = 1.0f;
 
-    int numOfInputs;
+    int numOfInputs = 1;
+
+    TraceLayout &traceLayout;
+    std::vector<juce::Path> tracePaths;
+    std::vector<float> traceScales;
+    std::vector<const juce::AudioBuffer<float> *> traceHistories;
 
     std::unique_ptr<CustomLookAndFeel> customLookAndFeel;
 
@@ -36,6 +46,27 @@ private:
 
     void inputComboBoxChanged();
 
+    juce::ComboBox layoutComboBox;
+
+    // Bus the TIME, GAIN, Show, Offset and Colour controls edit, or -1 for all of them
+    juce::ComboBox busComboBox;
+    int getSelectedBus() const;
+    void updateControlsForSelectedBus();
+    void restoreControls();
+
+    juce::ToggleButton visibleButton;
+    juce::Slider offsetSlider;
+    juce::Label offsetLabel;
+    juce::ComboBox colourComboBox;
+    juce::Array<juce::Colour> tracePalette; // Colour of each colourComboBox item, by index
+
+    void setTraceVisible(bool shouldBeVisible);
+    void setTraceOffset(float newOffset);
+    void setTraceColour(juce::Colour newColour);
+
+    juce::ComboBox scalingComboBox;
+    juce::ToggleButton logAmplitudeButton;
+
     juce::Slider bufferSlider;
     juce::Label bufferLabel;
 
@@ -47,14 +78,18 @@ private:
 
     void setupSliders();
 
-    void drawWaveform(juce::Graphics &g);
-    juce::Image oscillatorLogo;
+    juce::Rectangle<float> getScopeArea() const;
+    void drawWaveform(juce::Graphics &g, const TraceLayout::View &view);
+
+    // Pulls the envelopes published by the audio thread into the auto scales
+    void updateTraceScales();
+    float getTraceScale(int trace) const;
+    static float toLogAmplitude(float value);
+    void drawLogo(juce::Graphics &g);
 
     void mouseDoubleClick(const juce::MouseEvent &event) override;
     void sliderValueChanged(juce::Slider *slider) override;
 
-    void loadLogo();
-
     float strokeSize = 1.f; // Stroke width for the rectangle
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginEditor)
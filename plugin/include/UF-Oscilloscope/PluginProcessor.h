@@ -3,6 +3,8 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include <juce_audio_utils/juce_audio_utils.h>
+#include "UF-Oscilloscope/EnvelopeFollower.h"
+#include "UF-Oscilloscope/TraceLayout.h"
 
 class PluginProcessor final : public juce::AudioProcessor
 {
@@ -40,20 +42,70 @@ public:
     // ***********************************************************
 
     void processBufferHistory(juce::AudioBuffer<float> &historyBuffer, const juce::AudioBuffer<float> &buffer, int numChannels, int numSamples, int bufferID);
+
+    // Message thread only. The returned buffer stays alive until the next
+    // setHistoryBufferSize or releaseRetiredHistoryBuffers call.
     const juce::AudioBuffer<float> &getHistoryBuffer(int channel) const;
 
+    // Each bus keeps its own history length, i.e. its own timebase. Message
+    // thread only: the new buffer is allocated here and handed to the audio
+    // thread, which swaps it in at the start of its next block.
     void setHistoryBufferSize(int size);
+    void setHistoryBufferSize(int bufferID, int size);
+    int getHistoryBufferSize(int bufferID) const;
+    int getNumHistoryBuffers() const;
+
+    // Frees the buffers the audio thread has swapped out. Message thread only.
+    void releaseRetiredHistoryBuffers();
+
+    // Shows or hides a bus. Hidden buses keep only a minimal history, and get
+    // their full timebase allocated again when shown. Message thread only.
+    void setTraceVisible(int bufferID, bool shouldBeVisible);
+
+    // Per-bus display settings. They live here rather than in the editor so
+    // they survive the editor being closed. Message thread only.
+    TraceLayout &getTraceLayout();
+
+    // All-bus GAIN, applied on top of each bus's own gain. Message thread only.
+    void setDisplayGain(float newDisplayGain);
+    float getDisplayGain() const;
+
+    // Latest peak/RMS levels of a bus, computed once per block in processBlock
+    TraceEnvelope getTraceEnvelope(int bufferID) const;
 
     void setBPM();
     juce::Optional<double> getBPM();
 
 private:
-    bool historyBufferFlag = false;
-    int historyBufferSize = 75000;
-    int numSidechainInputs = 5;
+    static constexpr int numSidechainInputs = 5;
+    static constexpr int defaultHistoryBufferSize = 75000;
+    static constexpr int hiddenHistoryBufferSize = 1;
+
+    // History of one bus. The message thread allocates the pending buffer and
+    // frees the retired one; the audio thread only moves the pointers around,
+    // under a try-lock, so it never allocates or frees memory.
+    struct HistorySlot
+    {
+        std::unique_ptr<juce::AudioBuffer<float>> active;  // Written by the audio thread
+        std::unique_ptr<juce::AudioBuffer<float>> pending; // Waiting to become active
+        std::unique_ptr<juce::AudioBuffer<float>> retired; // Waiting to be freed
+        int requestedSize = defaultHistoryBufferSize;      // Message thread only
+        int allocatedSize = 0;                             // Message thread only
+        mutable juce::SpinLock lock;
+    };
+
+    void swapPendingHistory(int bufferID);
+    void updateHistoryAllocation(int bufferID);
+
+    std::array<HistorySlot, numSidechainInputs> histories;
+
+    TraceLayout traceLayout{numSidechainInputs};
+    float displayGain = 1.0f;
+
+    std::array<EnvelopeFollower, numSidechainInputs> envelopeFollowers;
+    std::array<TraceEnvelopeSnapshot, numSidechainInputs> traceEnvelopes;
 
     std::vector<juce::AudioBuffer<float>> inputBuffers;
-    std::vector<juce::AudioBuffer<float>> inputHistories;
     std::vector<int> historyBufferIndex;
 
     juce::Optional<double> bpm;
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+// How a trace's vertical scale is chosen
+//  - fixed:    GAIN knobs only
+//  - autoPeak: follows the bus's peak envelope
+//  - autoRms:  follows the bus's RMS envelope
+//  - frozen:   keeps the last automatic scale
+enum class TraceScaling
+{
+    fixed,
+    autoPeak,
+    autoRms,
+    frozen
+};
+
+// Display settings of a single input bus
+struct TraceSettings
+{
+    bool visible = false; // Change through PluginProcessor::setTraceVisible so the history follows
+    float gain = 1.0f;   // GAIN of this bus alone, on top of the all-bus GAIN
+    float offset = 0.0f; // Vertical offset, in half view heights, positive is up
+    juce::Colour colour = juce::Colours::wheat;
+
+    TraceScaling scaling = TraceScaling::fixed;
+    float autoScale = 1.0f;    // Last scale picked by automatic scaling
+    bool logAmplitude = false; // Draw amplitude in dB instead of linearly
+};
+
+// Decides which traces are drawn into which box of the scope area.
+//  - overlay: every visible trace shares one view
+//  - stack:   every visible trace gets its own row
+//  - grid:    every visible trace gets its own cell, in gridColumns columns
+class TraceLayout
+{
+public:
+    enum class Mode
+    {
+        overlay,
+        stack,
+        grid
+    };
+
+    struct View
+    {
+        juce::Rectangle<float> bounds;
+        std::vector<int> traces;
+    };
+
+    explicit TraceLayout(int numTraces);
+
+    int getNumTraces() const;
+    TraceSettings &getTrace(int trace);
+    const TraceSettings &getTrace(int trace) const;
+
+    void setMode(Mode newMode);
+    Mode getMode() const;
+
+    // Splits area into views and assigns every visible trace to one of them.
+    // The views are kept between calls, so a repaint doesn't allocate.
+    const std::vector<View> &layout(juce::Rectangle<float> area, float gap);
+
+private:
+    int getNumViews() const;
+    int getViewForTrace(int visibleIndex) const;
+
+    std::vector<TraceSettings> traces;
+    std::vector<View> views;
+
+    static constexpr int gridColumns = 2;
+
+    Mode mode = Mode::overlay;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TraceLayout)
+};
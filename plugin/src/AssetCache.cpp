@@ -0,0 +1,61 @@
+#include "UF-Oscilloscope/AssetCache.h"
+
+#include <BinaryData.h>
+
+JUCE_IMPLEMENT_SINGLETON(AssetCache)
+
+AssetCache::~AssetCache()
+{
+    clearSingletonInstance();
+}
+
+const juce::Image &AssetCache::getImage(const juce::String &resourceName, float displayScale)
+{
+    const auto key = std::make_pair(resourceName, toScaleKey(displayScale));
+
+    if (auto it = scaledImages.find(key); it != scaledImages.end())
+        return it->second;
+
+    const auto &decoded = getDecodedImage(resourceName);
+    juce::Image scaled;
+
+    if (decoded.isValid())
+    {
+        const auto scale = (float)key.second / 100.0f;
+        const auto width = juce::jmax(1, juce::roundToInt((float)decoded.getWidth() * scale));
+        const auto height = juce::jmax(1, juce::roundToInt((float)decoded.getHeight() * scale));
+
+        scaled = (width == decoded.getWidth() && height == decoded.getHeight())
+                     ? decoded
+                     : decoded.rescaled(width, height, juce::Graphics::highResamplingQuality);
+    }
+
+    return scaledImages.emplace(key, scaled).first->second;
+}
+
+juce::Rectangle<int> AssetCache::getLogicalBounds(const juce::String &resourceName)
+{
+    return getDecodedImage(resourceName).getBounds();
+}
+
+const juce::Image &AssetCache::getDecodedImage(const juce::String &resourceName)
+{
+    if (auto it = decodedImages.find(resourceName); it != decodedImages.end())
+        return it->second;
+
+    int dataSize = 0;
+    const auto *data = BinaryData::getNamedResource(resourceName.toRawUTF8(), dataSize);
+    juce::Image decoded;
+
+    if (data != nullptr)
+        decoded = juce::ImageFileFormat::loadFrom(data, (size_t)dataSize);
+    else
+        DBG("UF-0scillator asset not found: " + resourceName);
+
+    return decodedImages.emplace(resourceName, decoded).first->second;
+}
+
+int AssetCache::toScaleKey(float displayScale)
+{
+    return juce::jmax(1, juce::roundToInt(displayScale * 100.0f));
+}
@@ -0,0 +1,94 @@
+#include "UF-Oscilloscope/EnvelopeFollower.h"
+
+void EnvelopeFollower::prepare(double sampleRate)
+{
+    gateThreshold = juce::Decibels::decibelsToGain(gateThresholdDb);
+    attackCoefficient = getCoefficient(sampleRate, attackMs);
+    releaseCoefficient = getCoefficient(sampleRate, releaseMs);
+    rmsCoefficient = getCoefficient(sampleRate, rmsWindowMs);
+    reset();
+}
+
+void EnvelopeFollower::reset()
+{
+    peak = 0.0f;
+    meanSquare = 0.0f;
+    gated = true;
+}
+
+void EnvelopeFollower::process(const juce::AudioBuffer<float> &buffer, int numChannels, int numSamples)
+{
+    numChannels = juce::jmin(numChannels, buffer.getNumChannels());
+    if (numChannels == 0 || numSamples == 0)
+        return;
+
+    float blockPeak = 0.0f;
+    for (int channel = 0; channel < numChannels; ++channel)
+        blockPeak = juce::jmax(blockPeak, buffer.getMagnitude(channel, 0, numSamples));
+
+    // Hold the envelope through silence instead of letting it release to zero
+    gated = blockPeak < gateThreshold;
+    if (gated)
+        return;
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        float magnitude = 0.0f;
+        float square = 0.0f;
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float value = buffer.getSample(channel, sample);
+            magnitude = juce::jmax(magnitude, std::abs(value));
+            square += value * value;
+        }
+        square /= (float)numChannels;
+
+        const float coefficient = magnitude > peak ? attackCoefficient : releaseCoefficient;
+        peak = magnitude + coefficient * (peak - magnitude);
+        meanSquare = square + rmsCoefficient * (meanSquare - square);
+    }
+}
+
+TraceEnvelope EnvelopeFollower::getEnvelope() const
+{
+    return {peak, std::sqrt(meanSquare), gated};
+}
+
+float EnvelopeFollower::getCoefficient(double sampleRate, float timeMs)
+{
+    if (sampleRate <= 0.0 || timeMs <= 0.0f)
+        return 0.0f;
+
+    return (float)std::exp(-1.0 / (sampleRate * (double)timeMs * 0.001));
+}
+
+void TraceEnvelopeSnapshot::publish(const TraceEnvelope &envelope)
+{
+    const auto start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    peak.store(envelope.peak, std::memory_order_relaxed);
+    rms.store(envelope.rms, std::memory_order_relaxed);
+    gated.store(envelope.gated, std::memory_order_relaxed);
+
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+TraceEnvelope TraceEnvelopeSnapshot::read() const
+{
+    for (;;)
+    {
+        const auto before = sequence.load(std::memory_order_acquire);
+        if ((before & 1) != 0)
+            continue;
+
+        const TraceEnvelope envelope{peak.load(std::memory_order_relaxed),
+                                     rms.load(std::memory_order_relaxed),
+                                     gated.load(std::memory_order_relaxed)};
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before)
+            return envelope;
+    }
+}
@@ -3,13 +3,17 @@
 
 PluginEditor::PluginEditor(
     PluginProcessor &p)
-    : AudioProcessorEditor(&p), audioProcessor(p), bufferSlider()
+    : AudioProcessorEditor(&p), audioProcessor(p),
+      traceLayout(p.getTraceLayout()),
+      tracePaths((size_t)p.getNumHistoryBuffers()),
+      traceScales((size_t)p.getNumHistoryBuffers(), 1.0f),
+      traceHistories((size_t)p.getNumHistoryBuffers(), nullptr),
+      bufferSlider()
 {
     setupSliders();
+    restoreControls();
 
-    loadLogo();
-
-    setSize(550, 500);
+    setSize(550, 540);
     startTimerHz(60);
 }
 
@@ -24,18 +28,14 @@ void PluginEditor::paint(juce::Graphics &g)
     g.fillAll(juce::Colours::black);
     g.setColour(juce::Colours::blueviolet);
 
-    g.drawImage(oscillatorLogo, getWidth() / 2 - oscillatorLogo.getWidth() / 2, 20, 500, 100, 0, 0, 500, 100);
-
-    // Calculate the bounds for the rectangle
-    float left = 20;
-    float right = (float)getWidth() - 20;
-    float top = 60;
-    float bottom = (float)getHeight() - 150;
-    juce::Path rectanglePath;
-    rectanglePath.addRectangle(left, top, right - left, bottom - top);
-    g.strokePath(rectanglePath, juce::PathStrokeType(5.0f));
-    g.setColour(juce::Colours::wheat);
-    drawWaveform(g);
+    drawLogo(g);
+
+    for (const auto &view : traceLayout.layout(getScopeArea(), 10.0f))
+    {
+        g.setColour(juce::Colours::blueviolet);
+        g.drawRect(view.bounds, 2.5f);
+        drawWaveform(g, view);
+    }
 }
 
 void PluginEditor::resized()
@@ -49,120 +49,209 @@ void PluginEditor::resized()
     bufferSlider.setBounds(7 * getWidth() / 8 - bufferSliderWidth / 2 - 40, 385, bufferSliderWidth, bufferSliderHeight);
 
     auto syncButtonWidth = 40;
-    auto syncButtonHeight = 100;
+    auto syncButtonHeight = 50;
     syncButton.setBounds(3 * getWidth() / 8 - syncButtonWidth / 4, 400, syncButtonWidth, syncButtonHeight);
 
+    auto busComboBoxWidth = 80;
+    auto busComboBoxHeight = 24;
+    busComboBox.setBounds(3 * getWidth() / 8 - busComboBoxWidth / 2, 460, busComboBoxWidth, busComboBoxHeight);
+
     auto inputComboBoxWidth = 50;
     auto inputComboBoxHeight = 50;
     inputComboBox.setBounds(5 * getWidth() / 8 - inputComboBoxWidth / 2 - 40, 400, inputComboBoxWidth, inputComboBoxHeight);
+
+    auto layoutComboBoxWidth = 80;
+    auto layoutComboBoxHeight = 24;
+    layoutComboBox.setBounds(5 * getWidth() / 8 - layoutComboBoxWidth / 2 - 40, 460, layoutComboBoxWidth, layoutComboBoxHeight);
+
+    auto scalingComboBoxWidth = 90;
+    auto scalingComboBoxHeight = 24;
+    scalingComboBox.setBounds(getWidth() - 20 - scalingComboBoxWidth, 22, scalingComboBoxWidth, scalingComboBoxHeight);
+
+    auto logAmplitudeButtonWidth = 60;
+    auto logAmplitudeButtonHeight = 24;
+    logAmplitudeButton.setBounds(20, 22, logAmplitudeButtonWidth, logAmplitudeButtonHeight);
+
+    auto busRowHeight = 24;
+    visibleButton.setBounds(20, 505, 70, busRowHeight);
+    offsetSlider.setBounds(160, 505, 200, busRowHeight);
+    colourComboBox.setBounds(380, 505, 100, busRowHeight);
 }
 
 void PluginEditor::timerCallback()
 {
+    audioProcessor.releaseRetiredHistoryBuffers();
+    updateTraceScales();
     repaint();
 }
 
 // ******************************************
 
-void PluginEditor::drawWaveform(juce::Graphics &g)
+void PluginEditor::drawLogo(juce::Graphics &g)
 {
-    // Define your rectangle bounds and stroke size
-    float left = 20 + strokeSize + 0.8f;                                      // Adjust left bound
-    float right = static_cast<float>(getWidth()) - 20 - strokeSize - 0.8f;    // Adjust right bound
-    float top = 60 + strokeSize + 0.8f;                                       // Adjust top bound
-    float bottom = static_cast<float>(getHeight()) - 150 - strokeSize - 0.8f; // Adjust bottom bound
-    const float adjustedWidth = right - left;                                 // Width of the drawing area
-    const float adjustedHeight = bottom - top;                                // Height of the drawing area
-
-    // Check if histories are empty
-    // if (mainHistory.empty() && sidechain0History.empty() && sidechain1History.empty())
-    //     return;
-
-    auto drawWaveformFromHistory = [&](const juce::AudioBuffer<float> &bufferHistory, juce::Colour color)
-    {
-        const int numSamples = bufferHistory.getNumSamples();
-        const int numChannels = bufferHistory.getNumChannels();
+    // The cache hands back an image already resampled for this display,
+    // so it is blitted 1:1 into its logical bounds without scaling here
+    const auto displayScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    auto *assetCache = AssetCache::getInstance();
+    const auto &logo = assetCache->getImage("oscillatorLogo_png", displayScale);
+    if (!logo.isValid())
+        return;
+
+    auto logoBounds = assetCache->getLogicalBounds("oscillatorLogo_png").toFloat();
+    logoBounds.setPosition((float)getWidth() / 2.0f - logoBounds.getWidth() / 2.0f, 20.0f);
+    g.drawImage(logo, logoBounds);
+}
 
-        if (numSamples == 0 || numChannels == 0)
-            return;
+juce::Rectangle<float> PluginEditor::getScopeArea() const
+{
+    return {20.0f, 60.0f, (float)getWidth() - 40.0f, (float)getHeight() - 250.0f};
+}
 
-        const int pixels = 400;                            // Width of the drawing window
-        const int step = std::max(1, numSamples / pixels); // Number of samples per pixel
-        const int reducedSamples = numSamples / step;
+void PluginEditor::drawWaveform(juce::Graphics &g, const TraceLayout::View &view)
+{
+    if (view.traces.empty())
+        return;
 
-        float prevX = left;                        // Initialize the previous x position
-        float prevY = top + adjustedHeight / 2.0f; // Initialize the previous y position
+    const auto area = view.bounds.reduced(strokeSize + 0.8f);
+    const float top = area.getY();
+    const float bottom = area.getBottom();
+    const float centre = area.getCentreY();
+    const float halfHeight = area.getHeight() / 2.0f;
 
-        for (int i = 0; i < reducedSamples; ++i)
+    // One point per pixel column is all the screen can show
+    const int columns = juce::jmax(2, (int)area.getWidth());
+    const float columnWidth = area.getWidth() / (float)(columns - 1);
+
+    for (auto trace : view.traces)
+    {
+        tracePaths[(size_t)trace].clear();
+        tracePaths[(size_t)trace].preallocateSpace(3 * columns);
+        traceScales[(size_t)trace] = getTraceScale(trace);
+        traceHistories[(size_t)trace] = &audioProcessor.getHistoryBuffer(trace);
+    }
+
+    // Walk the columns once and decimate every trace of this view in the same
+    // pass, then stroke one path per trace instead of one line per segment
+    for (int column = 0; column < columns; ++column)
+    {
+        const float x = area.getX() + (float)column * columnWidth * xScale;
+
+        for (auto trace : view.traces)
         {
-            // Calculate start index for this step
-            const int startIdx = i * step;
+            const auto &history = *traceHistories[(size_t)trace];
+            const int numSamples = history.getNumSamples();
+            const int numChannels = history.getNumChannels();
 
-            // Select one representative sample (e.g., the first sample of the step)
+            if (numSamples == 0 || numChannels == 0)
+                continue;
+
+            // Select one representative sample per column, averaged across channels
+            const int sampleIndex = (int)((juce::int64)column * numSamples / columns);
             float sampleValue = 0.0f;
             for (int ch = 0; ch < numChannels; ++ch)
-            {
-                sampleValue += bufferHistory.getSample(ch, startIdx); // Aggregate across channels
-            }
-            sampleValue /= numChannels; // Average across channels
+                sampleValue += history.getSample(ch, sampleIndex);
+            sampleValue /= (float)numChannels;
 
-            // Calculate current x and y positions
-            float x = left + (i * adjustedWidth / reducedSamples) * xScale;
-            float y = top + adjustedHeight / 2.0f + sampleValue * yScale * (adjustedHeight / 2.0f);
+            const auto &settings = traceLayout.getTrace(trace);
+            float level = sampleValue * traceScales[(size_t)trace];
+            if (settings.logAmplitude)
+                level = toLogAmplitude(level);
 
-            // Clamp y values to stay within bounds
-            y = juce::jlimit(top, bottom, y);
+            const float y = juce::jlimit(top, bottom, centre + (level - settings.offset) * halfHeight);
 
-            if (i > 0) // Draw only if there's a previous point
-            {
-                g.setColour(color);
-                g.drawLine(prevX, prevY, x, y, strokeSize);
-            }
-
-            // Update previous x and y for the next line segment
-            prevX = x;
-            prevY = y;
+            auto &path = tracePaths[(size_t)trace];
+            if (column == 0)
+                path.startNewSubPath(x, y);
+            else
+                path.lineTo(x, y);
         }
-    };
-
-    // ! TEST V
-    if (numOfInputs > 0)
-    {
-        const auto mainInputBufferHistory = audioProcessor.getHistoryBuffer(0);
-        drawWaveformFromHistory(mainInputBufferHistory, juce::Colours::green);
     }
-    if (numOfInputs > 1)
-    {
-        const auto sidechainBuffer1History = audioProcessor.getHistoryBuffer(1);
-        drawWaveformFromHistory(sidechainBuffer1History, juce::Colours::red);
-    }
-    if (numOfInputs > 2)
-    {
-        const auto sidechainBuffer2History = audioProcessor.getHistoryBuffer(2);
-        drawWaveformFromHistory(sidechainBuffer2History, juce::Colours::blue);
-    }
-    if (numOfInputs > 3)
+
+    for (auto trace : view.traces)
     {
-        const auto sidechainBuffer3History = audioProcessor.getHistoryBuffer(3);
-        drawWaveformFromHistory(sidechainBuffer3History, juce::Colours::wheat);
+        g.setColour(traceLayout.getTrace(trace).colour);
+        g.strokePath(tracePaths[(size_t)trace], juce::PathStrokeType(strokeSize));
     }
-    if (numOfInputs > 4)
+}
+
+void PluginEditor::updateTraceScales()
+{
+    // Levels the envelopes are scaled to; a sine wave reaches peakTarget in either mode
+    const float peakTarget = 0.9f;
+    const float rmsTarget = peakTarget * juce::MathConstants<float>::sqrt2 / 2.0f;
+    const float minScale = 0.1f;
+    const float maxScale = 1000.0f;
+
+    for (int trace = 0; trace < traceLayout.getNumTraces(); ++trace)
     {
-        const auto sidechainBuffer4History = audioProcessor.getHistoryBuffer(4);
-        drawWaveformFromHistory(sidechainBuffer4History, juce::Colours::yellow);
+        auto &settings = traceLayout.getTrace(trace);
+        if (settings.scaling != TraceScaling::autoPeak && settings.scaling != TraceScaling::autoRms)
+            continue;
+
+        // Gated buses keep their last scale so silence isn't blown up into noise
+        const auto envelope = audioProcessor.getTraceEnvelope(trace);
+        if (envelope.gated)
+            continue;
+
+        const bool usePeak = settings.scaling == TraceScaling::autoPeak;
+        const float level = usePeak ? envelope.peak : envelope.rms;
+        if (level > 0.0f)
+            settings.autoScale = juce::jlimit(minScale, maxScale, (usePeak ? peakTarget : rmsTarget) / level);
     }
-    // ! TEST Λ
+}
+
+float PluginEditor::getTraceScale(int trace) const
+{
+    const auto &settings = traceLayout.getTrace(trace);
+    const float scale = audioProcessor.getDisplayGain() * settings.gain;
+
+    return settings.scaling == TraceScaling::fixed ? scale : scale * settings.autoScale;
+}
+
+float PluginEditor::toLogAmplitude(float value)
+{
+    // Maps -60 dB .. 0 dB onto 0 .. 1, keeping the sign of the sample
+    const float floorDb = -60.0f;
+    const float magnitudeDb = juce::Decibels::gainToDecibels(std::abs(value), floorDb);
+
+    return std::copysign(1.0f - magnitudeDb / floorDb, value);
 }
 
 void PluginEditor::setXScale(int newXScale)
 {
     // xScale = newXScale;
-    audioProcessor.setHistoryBufferSize(newXScale);
+    const int bus = getSelectedBus();
+    if (bus < 0)
+        audioProcessor.setHistoryBufferSize(newXScale);
+    else
+        audioProcessor.setHistoryBufferSize(bus, newXScale);
 }
 
 void PluginEditor::setYScale(float newYScale)
 {
-    yScale = newYScale;
+    const int bus = getSelectedBus();
+    if (bus < 0)
+        audioProcessor.setDisplayGain(newYScale);
+    else
+        traceLayout.getTrace(bus).gain = newYScale;
+}
+
+void PluginEditor::setLayoutMode(TraceLayout::Mode mode)
+{
+    traceLayout.setMode(mode);
+    repaint();
+}
+
+void PluginEditor::setTraceScaling(TraceScaling scaling)
+{
+    for (int trace = 0; trace < traceLayout.getNumTraces(); ++trace)
+        traceLayout.getTrace(trace).scaling = scaling;
+}
+
+void PluginEditor::setLogAmplitude(bool shouldUseLogAmplitude)
+{
+    for (int trace = 0; trace < traceLayout.getNumTraces(); ++trace)
+        traceLayout.getTrace(trace).logAmplitude = shouldUseLogAmplitude;
 }
 
 void PluginEditor::setupSliders()
@@ -178,10 +267,6 @@ void PluginEditor::setupSliders()
     bufferSlider.setValue(75000);
     bufferSlider.addListener(this);
     bufferSlider.setTextValueSuffix("");
-    bufferSlider.onValueChange = [this]()
-    {
-        setXScale(static_cast<int>(bufferSlider.getValue()));
-    };
     // bufferSlider.onDoubleClick = [this]() {
 
     // };
@@ -251,20 +336,117 @@ void PluginEditor::setupSliders()
     inputComboBoxLabel.setJustificationType(juce::Justification::centred);
     inputComboBoxLabel.attachToComponent(&inputComboBox, false);
     addAndMakeVisible(inputComboBoxLabel);
-}
 
-void PluginEditor::loadLogo()
-{
-    juce::File speakerImageFile = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("UF0/UF00/resources/images/oscillatorLogo.png");
-    if (speakerImageFile.existsAsFile())
+    layoutComboBox.addItem("Overlay", 1);
+    layoutComboBox.addItem("Stack", 2);
+    layoutComboBox.addItem("Grid", 3);
+    layoutComboBox.setSelectedId(1);
+    layoutComboBox.onChange = [this]()
     {
-        oscillatorLogo = juce::ImageFileFormat::loadFrom(speakerImageFile);
-        DBG("UF-0scillator logo found @: " + speakerImageFile.getFullPathName());
-        return;
+        switch (layoutComboBox.getSelectedId())
+        {
+        case 2:
+            setLayoutMode(TraceLayout::Mode::stack);
+            break;
+        case 3:
+            setLayoutMode(TraceLayout::Mode::grid);
+            break;
+        default:
+            setLayoutMode(TraceLayout::Mode::overlay);
+            break;
+        }
+    };
+    addAndMakeVisible(layoutComboBox);
+
+    busComboBox.addItem("All buses", 1);
+    for (int bus = 0; bus < traceLayout.getNumTraces(); ++bus)
+        busComboBox.addItem("Bus " + juce::String(bus), bus + 2);
+    busComboBox.setSelectedId(1);
+    busComboBox.onChange = [this]()
+    { updateControlsForSelectedBus(); };
+    addAndMakeVisible(busComboBox);
+
+    visibleButton.setButtonText("Show");
+    visibleButton.setColour(juce::ToggleButton::textColourId, juce::Colours::wheat);
+    visibleButton.onClick = [this]()
+    {
+        setTraceVisible(visibleButton.getToggleState());
+    };
+    addAndMakeVisible(visibleButton);
+
+    offsetSlider.setColour(juce::Slider::textBoxBackgroundColourId, juce::Colours::wheat);
+    offsetSlider.setColour(juce::Slider::textBoxTextColourId, juce::Colours::black);
+    offsetSlider.setSliderStyle(juce::Slider::SliderStyle::LinearHorizontal);
+    offsetSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 50, 20);
+    offsetSlider.setRange(-1.0, 1.0, 0.01);
+    offsetSlider.setValue(0.0, juce::dontSendNotification);
+    offsetSlider.onValueChange = [this]()
+    {
+        setTraceOffset((float)offsetSlider.getValue());
+    };
+    addAndMakeVisible(offsetSlider);
+    offsetLabel.setName("offsetLabel");
+    offsetLabel.setColour(juce::Label::textColourId, juce::Colours::wheat);
+    offsetLabel.setText("OFFSET", juce::NotificationType::dontSendNotification);
+    offsetLabel.setJustificationType(juce::Justification::centredRight);
+    offsetLabel.attachToComponent(&offsetSlider, true);
+    addAndMakeVisible(offsetLabel);
+
+    const std::pair<const char *, juce::Colour> paletteEntries[] = {{"Green", juce::Colours::green},
+                                                                    {"Red", juce::Colours::red},
+                                                                    {"Blue", juce::Colours::blue},
+                                                                    {"Wheat", juce::Colours::wheat},
+                                                                    {"Yellow", juce::Colours::yellow},
+                                                                    {"Cyan", juce::Colours::cyan},
+                                                                    {"Magenta", juce::Colours::magenta},
+                                                                    {"Orange", juce::Colours::orange},
+                                                                    {"White", juce::Colours::white}};
+    for (const auto &[name, colour] : paletteEntries)
+    {
+        tracePalette.add(colour);
+        colourComboBox.addItem(name, tracePalette.size());
     }
-    DBG("UF-0scillator logo not found @: " + speakerImageFile.getFullPathName());
-    jassertfalse;
-    oscillatorLogo = juce::Image();
+    colourComboBox.onChange = [this]()
+    {
+        const int index = colourComboBox.getSelectedId() - 1;
+        if (juce::isPositiveAndBelow(index, tracePalette.size()))
+            setTraceColour(tracePalette[index]);
+    };
+    addAndMakeVisible(colourComboBox);
+
+    scalingComboBox.addItem("Fixed", 1);
+    scalingComboBox.addItem("Auto Peak", 2);
+    scalingComboBox.addItem("Auto RMS", 3);
+    scalingComboBox.addItem("Frozen", 4);
+    scalingComboBox.setSelectedId(1);
+    scalingComboBox.onChange = [this]()
+    {
+        switch (scalingComboBox.getSelectedId())
+        {
+        case 2:
+            setTraceScaling(TraceScaling::autoPeak);
+            break;
+        case 3:
+            setTraceScaling(TraceScaling::autoRms);
+            break;
+        case 4:
+            setTraceScaling(TraceScaling::frozen);
+            break;
+        default:
+            setTraceScaling(TraceScaling::fixed);
+            break;
+        }
+    };
+    addAndMakeVisible(scalingComboBox);
+
+    logAmplitudeButton.setButtonText("dB");
+    logAmplitudeButton.setColour(juce::ToggleButton::textColourId, juce::Colours::wheat);
+    logAmplitudeButton.setToggleState(false, juce::NotificationType::dontSendNotification);
+    logAmplitudeButton.onClick = [this]()
+    {
+        setLogAmplitude(logAmplitudeButton.getToggleState());
+    };
+    addAndMakeVisible(logAmplitudeButton);
 }
 
 void PluginEditor::mouseDoubleClick(const juce::MouseEvent &event)
@@ -294,4 +476,73 @@ void PluginEditor::sliderValueChanged(juce::Slider *slider)
 void PluginEditor::inputComboBoxChanged()
 {
     numOfInputs = inputComboBox.getSelectedId();
+
+    for (int trace = 0; trace < traceLayout.getNumTraces(); ++trace)
+        audioProcessor.setTraceVisible(trace, trace < numOfInputs);
+
+    updateControlsForSelectedBus();
+}
+
+int PluginEditor::getSelectedBus() const
+{
+    return busComboBox.getSelectedId() - 2;
+}
+
+void PluginEditor::updateControlsForSelectedBus()
+{
+    const int bus = getSelectedBus();
+    const auto &settings = traceLayout.getTrace(juce::jmax(0, bus));
+
+    bufferSlider.setValue(audioProcessor.getHistoryBufferSize(juce::jmax(0, bus)), juce::dontSendNotification);
+    gainSlider.setValue(bus < 0 ? audioProcessor.getDisplayGain() : settings.gain, juce::dontSendNotification);
+    offsetSlider.setValue(settings.offset, juce::dontSendNotification);
+
+    bool allVisible = true;
+    for (int trace = 0; trace < traceLayout.getNumTraces(); ++trace)
+        allVisible = allVisible && traceLayout.getTrace(trace).visible;
+    visibleButton.setToggleState(bus < 0 ? allVisible : settings.visible, juce::dontSendNotification);
+
+    // One colour for every bus would defeat the colour mapping
+    colourComboBox.setEnabled(bus >= 0);
+    colourComboBox.setSelectedId(bus < 0 ? 0 : tracePalette.indexOf(settings.colour) + 1, juce::dontSendNotification);
+}
+
+void PluginEditor::setTraceVisible(bool shouldBeVisible)
+{
+    const int bus = getSelectedBus();
+    for (int trace = 0; trace < traceLayout.getNumTraces(); ++trace)
+        if (bus < 0 || trace == bus)
+            audioProcessor.setTraceVisible(trace, shouldBeVisible);
+}
+
+void PluginEditor::setTraceOffset(float newOffset)
+{
+    const int bus = getSelectedBus();
+    for (int trace = 0; trace < traceLayout.getNumTraces(); ++trace)
+        if (bus < 0 || trace == bus)
+            traceLayout.getTrace(trace).offset = newOffset;
+}
+
+void PluginEditor::setTraceColour(juce::Colour newColour)
+{
+    const int bus = getSelectedBus();
+    if (bus >= 0)
+        traceLayout.getTrace(bus).colour = newColour;
+}
+
+void PluginEditor::restoreControls()
+{
+    // The settings outlive the editor, so a reopened editor starts from them
+    int numVisible = 0;
+    for (int trace = 0; trace < traceLayout.getNumTraces(); ++trace)
+        if (traceLayout.getTrace(trace).visible)
+            numVisible = trace + 1;
+    numOfInputs = juce::jmax(1, numVisible);
+    inputComboBox.setSelectedId(numOfInputs, juce::dontSendNotification);
+
+    layoutComboBox.setSelectedId((int)traceLayout.getMode() + 1, juce::dontSendNotification);
+    scalingComboBox.setSelectedId((int)traceLayout.getTrace(0).scaling + 1, juce::dontSendNotification);
+    logAmplitudeButton.setToggleState(traceLayout.getTrace(0).logAmplitude, juce::dontSendNotification);
+
+    updateControlsForSelectedBus();
 }
\ No newline at end of file
@@ -11,6 +11,17 @@ PluginProcessor::PluginProcessor()
               .withInput("AuxInput4", juce::AudioChannelSet::stereo())
               .withOutput("Output", juce::AudioChannelSet::stereo()))
 {
+    // Only visible buses pay for a full history
+    for (int bufferID = 0; bufferID < numSidechainInputs; ++bufferID)
+    {
+        auto &slot = histories[(size_t)bufferID];
+        slot.allocatedSize = traceLayout.getTrace(bufferID).visible ? slot.requestedSize : hiddenHistoryBufferSize;
+        slot.active = std::make_unique<juce::AudioBuffer<float>>(2, slot.allocatedSize);
+        slot.active->clear();
+    }
+
+    inputBuffers.resize(numSidechainInputs);
+    historyBufferIndex.resize(numSidechainInputs, 0);
 }
 
 PluginProcessor::~PluginProcessor() {}
@@ -83,25 +94,20 @@ void PluginProcessor::changeProgramName(int index,
 
 void PluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    juce::ignoreUnused(sampleRate, samplesPerBlock);
-
-    inputBuffers.resize(numSidechainInputs);
-    inputHistories.resize(numSidechainInputs);
-    historyBufferIndex.resize(numSidechainInputs, 0);
-
     for (int bufferID = 0; bufferID < numSidechainInputs; ++bufferID)
     {
+        swapPendingHistory(bufferID);
         inputBuffers[bufferID].setSize(2, samplesPerBlock);
-        inputHistories[bufferID].setSize(2, historyBufferSize);
         inputBuffers[bufferID].clear();
+        envelopeFollowers[(size_t)bufferID].prepare(sampleRate);
     }
 }
 
 void PluginProcessor::releaseResources()
 {
-    for (auto &buffer : inputHistories)
+    for (auto &slot : histories)
     {
-        buffer.clear();
+        slot.active->clear();
     }
 }
 
@@ -149,10 +155,21 @@ void PluginProcessor::processBlock(juce::AudioBuffer<float> &buffer,
 
         if (sidechainBuffer.getNumChannels() > 0)
         {
-            processBufferHistory(inputHistories[bufferID], sidechainBuffer, 2, numSamples, bufferID);
+            swapPendingHistory(bufferID);
+            processBufferHistory(*histories[(size_t)bufferID].active, sidechainBuffer, 2, numSamples, bufferID);
+
+            envelopeFollowers[(size_t)bufferID].process(sidechainBuffer, 2, numSamples);
+            traceEnvelopes[(size_t)bufferID].publish(envelopeFollowers[(size_t)bufferID].getEnvelope());
+
             output.addFrom(0, 0, sidechainBuffer, 0, 0, numSamples);
             output.addFrom(1, 0, sidechainBuffer, 1, 0, numSamples);
         }
+        else
+        {
+            // A bus without channels is silent, don't leave its last levels published
+            envelopeFollowers[(size_t)bufferID].reset();
+            traceEnvelopes[(size_t)bufferID].publish(envelopeFollowers[(size_t)bufferID].getEnvelope());
+        }
     }
 
     setBPM();
@@ -200,17 +217,13 @@ juce::Optional<double> PluginProcessor::getBPM()
 // Get audio history
 const juce::AudioBuffer<float> &PluginProcessor::getHistoryBuffer(int channel) const
 {
-    return inputHistories[channel];
+    const juce::SpinLock::ScopedLockType lock(histories[(size_t)channel].lock);
+    return *histories[(size_t)channel].active;
 }
 
 void PluginProcessor::processBufferHistory(juce::AudioBuffer<float> &historyBuffer, const juce::AudioBuffer<float> &buffer, int numChannels, int numSamples, int bufferID)
 {
-    if (historyBufferFlag)
-    {
-        historyBuffer.setSize(numChannels, historyBufferSize);
-        historyBuffer.clear();
-        historyBufferFlag = false;
-    }
+    const int historyBufferSize = historyBuffer.getNumSamples();
 
     int bufferCopySize = std::min(historyBufferSize, numSamples);
 
@@ -237,8 +250,97 @@ void PluginProcessor::processBufferHistory(juce::AudioBuffer<float> &historyBuff
 
 void PluginProcessor::setHistoryBufferSize(int size)
 {
-    historyBufferSize = size;
-    historyBufferFlag = true;
+    for (int bufferID = 0; bufferID < numSidechainInputs; ++bufferID)
+        setHistoryBufferSize(bufferID, size);
+}
+
+void PluginProcessor::setHistoryBufferSize(int bufferID, int size)
+{
+    histories[(size_t)bufferID].requestedSize = juce::jmax(1, size);
+    updateHistoryAllocation(bufferID);
+}
+
+void PluginProcessor::setTraceVisible(int bufferID, bool shouldBeVisible)
+{
+    traceLayout.getTrace(bufferID).visible = shouldBeVisible;
+    updateHistoryAllocation(bufferID);
+}
+
+void PluginProcessor::updateHistoryAllocation(int bufferID)
+{
+    auto &slot = histories[(size_t)bufferID];
+    const int size = traceLayout.getTrace(bufferID).visible ? slot.requestedSize : hiddenHistoryBufferSize;
+    if (size == slot.allocatedSize)
+        return;
+
+    slot.allocatedSize = size;
+    auto replacement = std::make_unique<juce::AudioBuffer<float>>(2, size);
+    replacement->clear();
+
+    // Freed when this function returns, after the lock has been released
+    std::unique_ptr<juce::AudioBuffer<float>> retired, stalePending;
+    {
+        const juce::SpinLock::ScopedLockType lock(slot.lock);
+        retired = std::move(slot.retired);
+        stalePending = std::move(slot.pending);
+        slot.pending = std::move(replacement);
+    }
+}
+
+int PluginProcessor::getHistoryBufferSize(int bufferID) const
+{
+    return histories[(size_t)bufferID].requestedSize;
+}
+
+void PluginProcessor::releaseRetiredHistoryBuffers()
+{
+    for (auto &slot : histories)
+    {
+        std::unique_ptr<juce::AudioBuffer<float>> retired;
+        {
+            const juce::SpinLock::ScopedLockType lock(slot.lock);
+            retired = std::move(slot.retired);
+        }
+    }
+}
+
+void PluginProcessor::swapPendingHistory(int bufferID)
+{
+    auto &slot = histories[(size_t)bufferID];
+
+    // Never wait for the message thread; a busy lock just defers the swap a block
+    const juce::SpinLock::ScopedTryLockType lock(slot.lock);
+    if (!lock.isLocked() || slot.pending == nullptr || slot.retired != nullptr)
+        return;
+
+    slot.retired = std::move(slot.active);
+    slot.active = std::move(slot.pending);
+    historyBufferIndex[(size_t)bufferID] = 0;
+}
+
+int PluginProcessor::getNumHistoryBuffers() const
+{
+    return numSidechainInputs;
+}
+
+TraceLayout &PluginProcessor::getTraceLayout()
+{
+    return traceLayout;
+}
+
+void PluginProcessor::setDisplayGain(float newDisplayGain)
+{
+    displayGain = newDisplayGain;
+}
+
+float PluginProcessor::getDisplayGain() const
+{
+    return displayGain;
+}
+
+TraceEnvelope PluginProcessor::getTraceEnvelope(int bufferID) const
+{
+    return traceEnvelopes[(size_t)bufferID].read();
 }
 
 // This creates new instances of the plugin.
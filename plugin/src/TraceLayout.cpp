@@ -0,0 +1,100 @@
+#include "UF-Oscilloscope/TraceLayout.h"
+
+TraceLayout::TraceLayout(int numTraces)
+    : traces((size_t)numTraces)
+{
+    const juce::Colour defaultColours[] = {juce::Colours::green,
+                                           juce::Colours::red,
+                                           juce::Colours::blue,
+                                           juce::Colours::wheat,
+                                           juce::Colours::yellow};
+
+    for (int trace = 0; trace < numTraces; ++trace)
+        traces[(size_t)trace].colour = defaultColours[trace % juce::numElementsInArray(defaultColours)];
+
+    // The main input is shown until the user picks otherwise
+    if (numTraces > 0)
+        traces[0].visible = true;
+
+    views.reserve((size_t)numTraces);
+}
+
+int TraceLayout::getNumTraces() const
+{
+    return (int)traces.size();
+}
+
+TraceSettings &TraceLayout::getTrace(int trace)
+{
+    return traces[(size_t)trace];
+}
+
+const TraceSettings &TraceLayout::getTrace(int trace) const
+{
+    return traces[(size_t)trace];
+}
+
+void TraceLayout::setMode(Mode newMode)
+{
+    mode = newMode;
+}
+
+TraceLayout::Mode TraceLayout::getMode() const
+{
+    return mode;
+}
+
+const std::vector<TraceLayout::View> &TraceLayout::layout(juce::Rectangle<float> area, float gap)
+{
+    const int numViews = getNumViews();
+
+    views.resize((size_t)numViews);
+    for (auto &view : views)
+        view.traces.clear();
+
+    int visibleIndex = 0;
+    for (int trace = 0; trace < getNumTraces(); ++trace)
+    {
+        if (!traces[(size_t)trace].visible)
+            continue;
+
+        views[(size_t)getViewForTrace(visibleIndex)].traces.push_back(trace);
+        ++visibleIndex;
+    }
+
+    const int columns = mode == Mode::grid ? juce::jmin(gridColumns, numViews) : 1;
+    const int rows = (numViews + columns - 1) / columns;
+    const float cellWidth = (area.getWidth() - gap * (float)(columns - 1)) / (float)columns;
+    const float cellHeight = (area.getHeight() - gap * (float)(rows - 1)) / (float)rows;
+
+    for (int viewIndex = 0; viewIndex < numViews; ++viewIndex)
+    {
+        const int column = viewIndex % columns;
+        const int row = viewIndex / columns;
+        views[(size_t)viewIndex].bounds = {area.getX() + (float)column * (cellWidth + gap),
+                                           area.getY() + (float)row * (cellHeight + gap),
+                                           cellWidth,
+                                           cellHeight};
+    }
+
+    return views;
+}
+
+int TraceLayout::getNumViews() const
+{
+    if (mode == Mode::overlay)
+        return 1;
+
+    int numVisible = 0;
+    for (const auto &trace : traces)
+        if (trace.visible)
+            ++numVisible;
+
+    // Keep an empty box on screen when nothing is visible
+    return juce::jmax(1, numVisible);
+}
+
+int TraceLayout::getViewForTrace(int visibleIndex) const
+{
+    return mode == Mode::overlay ? 0 : visibleIndex;
+}